@@ -0,0 +1,56 @@
+/*
+ShiftDisplay example
+by MiguelPynto
+Receive binary frames over I2C, applied straight to the display without text formatting
+https://miguelpynto.github.io/ShiftDisplay/
+*/
+
+#include <ShiftDisplay.h>
+#include <ShiftDisplayDecoder.h>
+#include <Wire.h>
+// connect pin A4 to other Arduino pin A4, pin A5 to other Arduino pin A5, and GND to other Arduino GND
+
+// a frame is sent by the other Arduino as:
+// FRAME_SYNC, command, section, length, payload..., checksum (xor of command to last payload byte)
+// eg: show "Hi" with a dot on the leftmost: 0x7E 'C' 0 2 'H' 'i' 0x60, then 0x7E 'D' 0 1 0x01 0x44
+
+const int DISPLAY_ADDRESS = 8;
+const int LATCH_PIN = 6;
+const int CLOCK_PIN = 7;
+const int DATA_PIN = 5;
+const DisplayType DISPLAY_TYPE = COMMON_CATHODE; // COMMON_CATHODE or COMMON_ANODE
+const int DISPLAY_SIZE = 4; // number of digits on display
+const int BUFFER_SIZE = 64; // received bytes waiting to be decoded
+
+ShiftDisplay display(LATCH_PIN, CLOCK_PIN, DATA_PIN, DISPLAY_TYPE, DISPLAY_SIZE);
+ShiftDisplayDecoder decoder(display);
+
+// bytes are only copied in the receive interrupt, and decoded (applied to display) in loop
+byte buffer[BUFFER_SIZE];
+volatile byte bufferHead = 0; // position to write next byte, only modified by receiveEvent
+volatile byte bufferTail = 0; // position to read next byte, only modified by loop
+
+void receiveEvent(int numBytes) {
+	while (Wire.available() > 0) {
+		byte next = (bufferHead + 1) % BUFFER_SIZE;
+		if (next == bufferTail) { // buffer full, byte is lost (its frame will most likely fail the checksum)
+			Wire.read();
+			continue;
+		}
+		buffer[bufferHead] = Wire.read();
+		bufferHead = next;
+	}
+}
+
+void setup() {
+	Wire.begin(DISPLAY_ADDRESS); // this is slave
+	Wire.onReceive(receiveEvent);
+}
+
+void loop() {
+	while (bufferTail != bufferHead) {
+		decoder.decode(buffer[bufferTail]); // apply every frame completed
+		bufferTail = (bufferTail + 1) % BUFFER_SIZE;
+	}
+	display.update(); // show current stored value
+}
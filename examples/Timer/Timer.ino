@@ -10,6 +10,7 @@ https://miguelpynto.github.io/ShiftDisplay/
 const DisplayType DISPLAY_TYPE = COMMON_CATHODE; // COMMON_CATHODE or COMMON_ANODE
 const int DISPLAY_SIZE = 3; // number of digits on display
 const int BUTTON_PIN = 2; // connect one end of button to pin 2 and other to ground
+FLASH_ENCODED_TEXT(END_TEXT, "end", DISPLAY_SIZE); // encoded at compile time, kept in program memory
 
 volatile bool buttonPressed;
 
@@ -52,7 +53,7 @@ void loop() {
 	}
 
 	// finished
-	display.set("end");
+	display.set(END_TEXT);
 	while (!buttonPressed)
 		display.update(); // show end while button isnt pressed
 
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+ShiftDisplay
+by MiguelPynto
+Convert a dumpTrace() output into a VCD file for a waveform viewer (eg: GTKWave)
+https://miguelpynto.github.io/ShiftDisplay/
+
+usage: trace2vcd.py [input] [output]
+input is the text copied from serial monitor (default stdin), other lines are ignored;
+output is the VCD file (default stdout);
+latch timing summary is printed to stderr;
+blank time (display cleared, eg: by clear() or between show() calls) needs a bus level trace,
+a blank frame being one where every shifted bit has the same level;
+micros() has a resolution of 4us on 16MHz AVR (8us on 8MHz), so changes recorded within the same tick
+are merged in the VCD (short clock pulses may not be visible) and times below the resolution are not meaningful.
+"""
+
+import sys
+from functools import reduce
+from math import gcd
+
+WIRES = (("latch", "l"), ("clock", "c"), ("data", "d"))
+WRAP = 1 << 32  # micros() overflow
+
+
+def read_trace(lines):
+	entries = []
+	for line in lines:
+		fields = line.split()
+		if len(fields) not in (2, 4) or not all(f.isdigit() for f in fields): # latch or bus level
+			continue
+		entries.append((int(fields[0]), tuple(int(f) for f in fields[1:])))
+	return entries
+
+
+def unwrap(entries):
+	# make timestamps relative to first entry and monotonic across micros() overflow
+	result = []
+	time = 0
+	previous = entries[0][0]
+	for raw, levels in entries:
+		time += (raw - previous) % WRAP
+		previous = raw
+		result.append((time, levels))
+	return result
+
+
+def write_vcd(entries, output):
+	output.write("$timescale 1us $end\n")
+	output.write("$scope module shiftdisplay $end\n")
+	for name, code in WIRES[:len(entries[0][1])]:
+		output.write("$var wire 1 %s %s $end\n" % (code, name))
+	output.write("$upscope $end\n$enddefinitions $end\n")
+	last = None
+	for index, (time, levels) in enumerate(entries):
+		if index + 1 < len(entries) and entries[index + 1][0] == time: # same tick, keep only final levels
+			continue
+		changes = [(level, code) for i, (level, (_, code)) in enumerate(zip(levels, WIRES)) if last is None or last[i] != level]
+		if changes:
+			output.write("#%d\n" % time)
+			for level, code in changes:
+				output.write("%d%s\n" % (level, code))
+		last = levels
+
+
+def summarize(entries, output):
+	rises = [] # latch low to high, when shift registers output new value
+	shifts = [] # latch high to low to high, time spent shifting
+	blanks = [] # for each rise, if shifted frame is empty (bus level only)
+	isBus = len(entries[0][1]) == len(WIRES)
+	last = None
+	fall = None
+	bits = [] # data levels shifted since latch went low
+	for time, levels in entries:
+		if last is not None and last[0] != levels[0]:
+			if levels[0]:
+				rises.append(time)
+				blanks.append(len(bits) > 0 and len(set(bits)) == 1)
+				if fall is not None:
+					shifts.append(time - fall)
+			else:
+				fall = time
+				bits = []
+		elif isBus and last is not None and not levels[0] and levels[1] and not last[1]: # clock rise while shifting
+			bits.append(levels[2])
+		last = levels
+
+	steps = [b[0] - a[0] for a, b in zip(entries, entries[1:]) if b[0] != a[0]]
+	if steps:
+		output.write("timer resolution (us): %d, estimated from timestamps, differences below it are not measured\n" % reduce(gcd, steps))
+	periods = [b - a for a, b in zip(rises, rises[1:])]
+	blankTimes = [b - a for a, b, blank in zip(rises, rises[1:], blanks) if blank]
+	for label, values in (("latch period", periods), ("shifting time", shifts), ("blank time", blankTimes)):
+		if values:
+			output.write("%s (us): min %d, avg %.1f, max %d, jitter %d\n" % (label, min(values), sum(values) / len(values), max(values), max(values) - min(values)))
+	if not isBus:
+		output.write("blank time: needs a bus level trace\n")
+
+
+def main(args):
+	source = open(args[0]) if len(args) > 0 else sys.stdin
+	target = open(args[1], "w") if len(args) > 1 else sys.stdout
+	entries = read_trace(source)
+	if not entries:
+		sys.exit("no trace entries found")
+	entries = unwrap(entries)
+	write_vcd(entries, target)
+	summarize(entries, sys.stderr)
+
+
+if __name__ == "__main__":
+	main(sys.argv[1:])
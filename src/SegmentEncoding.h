@@ -0,0 +1,211 @@
+/*
+ShiftDisplay
+by MiguelPynto
+Arduino library for driving 7-segment displays using shift registers
+https://miguelpynto.github.io/ShiftDisplay/
+*/
+
+#ifndef SegmentEncoding_h
+#define SegmentEncoding_h
+#include "Arduino.h"
+
+// fonts of each segment type, kept in program memory
+// a display only links the font of the segment type given to its constructor
+
+struct SegmentType {
+	byte id; // 7, 14 or 16 segments
+	byte segmentCount; // segment lines on each display index, 8 (one shift register) or 16 (two)
+	int dotSegment; // segment line of the dot, or -1 if none
+	const uint16_t *numbers; // font for 0 to 9, in program memory
+	const uint16_t *letters; // font for a to z, in program memory
+	uint16_t minus;
+};
+
+namespace SegmentEncoding {
+
+// encoding for 7 segment characters in abcdefgp format (common cathode, LSBFIRST)
+
+constexpr uint16_t NUMBERS_7[] PROGMEM = {
+	//ABCDEFG
+	 B11111100, // 0
+	 B01100000, // 1
+	 B11011010, // 2
+	 B11110010, // 3
+	 B01100110, // 4
+	 B10110110, // 5
+	 B10111110, // 6
+	 B11100000, // 7
+	 B11111110, // 8
+	 B11100110  // 9
+};
+
+constexpr uint16_t LETTERS_7[] PROGMEM = {
+	//ABCDEFG
+	 B11101110, // a
+	 B00111110, // b
+	 B10011100, // c
+	 B01111010, // d
+	 B10011110, // e
+	 B10001110, // f
+	 B10111100, // g
+	 B01101110, // h
+	 B00001100, // i
+	 B01111000, // j
+	 B10101110, // k
+	 B00011100, // l
+	 B11101100, // m
+	 B00101010, // n
+	 B00111010, // o
+	 B11001110, // p
+	 B11100110, // q
+	 B10001100, // r
+	 B10110110, // s
+	 B00011110, // t
+	 B00111000, // u
+	 B01111100, // v
+	 B01111110, // w
+	 B01101100, // x
+	 B01110110, // y
+	 B11011010  // z
+};
+
+constexpr uint16_t MINUS_7 = B00000010;
+
+// encoding for 14 and 16 segment characters, built at compile time from segment names
+// word high byte is abcdefgp like above (g is g1), low byte is the remaining segments
+// 16 segment splits a and d in halves, using the p and last bits for the second halves (so no dot)
+
+const byte SEGMENT_A = 15; // top (left half on 16 segment)
+const byte SEGMENT_B = 14; // upper right
+const byte SEGMENT_C = 13; // lower right
+const byte SEGMENT_D = 12; // bottom (left half on 16 segment)
+const byte SEGMENT_E = 11; // lower left
+const byte SEGMENT_F = 10; // upper left
+const byte SEGMENT_G1 = 9; // middle left
+const byte SEGMENT_P = 8; // dot
+const byte SEGMENT_G2 = 7; // middle right
+const byte SEGMENT_H = 6; // upper left diagonal
+const byte SEGMENT_I = 5; // upper vertical
+const byte SEGMENT_J = 4; // upper right diagonal
+const byte SEGMENT_K = 3; // lower left diagonal
+const byte SEGMENT_L = 2; // lower vertical
+const byte SEGMENT_M = 1; // lower right diagonal
+const byte SEGMENT_A2 = 0; // top right half, 16 segment only
+const byte SEGMENT_D2 = SEGMENT_P; // bottom right half, 16 segment only
+
+// combine segments into a character
+constexpr uint16_t segments() {
+	return 0;
+}
+template <typename... Segments>
+constexpr uint16_t segments(byte segment, Segments... others) {
+	return (1u << segment) | segments(others...);
+}
+
+// convert a 14 segment character to 16 segment, doubling a and d
+constexpr uint16_t toSixteenSegment(uint16_t code) {
+	return (code & ~(1u << SEGMENT_P))
+		| (bitRead(code, SEGMENT_A) ? 1u << SEGMENT_A2 : 0)
+		| (bitRead(code, SEGMENT_D) ? 1u << SEGMENT_D2 : 0);
+}
+
+// convert a 7 segment character (abcdefgp) to 14 segment, g lights both middle halves
+constexpr uint16_t toFourteenSegment(byte code) {
+	return ((uint16_t) code << 8) | (bitRead(code, 1) ? 1u << SEGMENT_G2 : 0);
+}
+
+constexpr uint16_t NUMBERS_14[] PROGMEM = {
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_J, SEGMENT_K), // 0
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_J), // 1
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_D, SEGMENT_E, SEGMENT_G1, SEGMENT_G2), // 2
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_G2), // 3
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // 4
+	segments(SEGMENT_A, SEGMENT_C, SEGMENT_D, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // 5
+	segments(SEGMENT_A, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // 6
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C), // 7
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // 8
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_F, SEGMENT_G1, SEGMENT_G2)  // 9
+};
+
+constexpr uint16_t LETTERS_14[] PROGMEM = {
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // a
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_G2, SEGMENT_I, SEGMENT_L), // b
+	segments(SEGMENT_A, SEGMENT_D, SEGMENT_E, SEGMENT_F), // c
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_I, SEGMENT_L), // d
+	segments(SEGMENT_A, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_G1), // e
+	segments(SEGMENT_A, SEGMENT_E, SEGMENT_F, SEGMENT_G1), // f
+	segments(SEGMENT_A, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_G2), // g
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // h
+	segments(SEGMENT_A, SEGMENT_D, SEGMENT_I, SEGMENT_L), // i
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E), // j
+	segments(SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_J, SEGMENT_M), // k
+	segments(SEGMENT_D, SEGMENT_E, SEGMENT_F), // l
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_E, SEGMENT_F, SEGMENT_H, SEGMENT_J), // m
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_E, SEGMENT_F, SEGMENT_H, SEGMENT_M), // n
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F), // o
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2), // p
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F, SEGMENT_M), // q
+	segments(SEGMENT_A, SEGMENT_B, SEGMENT_E, SEGMENT_F, SEGMENT_G1, SEGMENT_G2, SEGMENT_M), // r
+	segments(SEGMENT_A, SEGMENT_C, SEGMENT_D, SEGMENT_G2, SEGMENT_H), // s
+	segments(SEGMENT_A, SEGMENT_I, SEGMENT_L), // t
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_D, SEGMENT_E, SEGMENT_F), // u
+	segments(SEGMENT_E, SEGMENT_F, SEGMENT_J, SEGMENT_K), // v
+	segments(SEGMENT_B, SEGMENT_C, SEGMENT_E, SEGMENT_F, SEGMENT_K, SEGMENT_M), // w
+	segments(SEGMENT_H, SEGMENT_J, SEGMENT_K, SEGMENT_M), // x
+	segments(SEGMENT_H, SEGMENT_J, SEGMENT_L), // y
+	segments(SEGMENT_A, SEGMENT_D, SEGMENT_J, SEGMENT_K)  // z
+};
+
+constexpr uint16_t MINUS_14 = segments(SEGMENT_G1, SEGMENT_G2);
+
+constexpr uint16_t NUMBERS_16[] PROGMEM = {
+	toSixteenSegment(NUMBERS_14[0]), // 0
+	toSixteenSegment(NUMBERS_14[1]), // 1
+	toSixteenSegment(NUMBERS_14[2]), // 2
+	toSixteenSegment(NUMBERS_14[3]), // 3
+	toSixteenSegment(NUMBERS_14[4]), // 4
+	toSixteenSegment(NUMBERS_14[5]), // 5
+	toSixteenSegment(NUMBERS_14[6]), // 6
+	toSixteenSegment(NUMBERS_14[7]), // 7
+	toSixteenSegment(NUMBERS_14[8]), // 8
+	toSixteenSegment(NUMBERS_14[9])  // 9
+};
+
+constexpr uint16_t LETTERS_16[] PROGMEM = {
+	toSixteenSegment(LETTERS_14[0]), // a
+	toSixteenSegment(LETTERS_14[1]), // b
+	toSixteenSegment(LETTERS_14[2]), // c
+	toSixteenSegment(LETTERS_14[3]), // d
+	toSixteenSegment(LETTERS_14[4]), // e
+	toSixteenSegment(LETTERS_14[5]), // f
+	toSixteenSegment(LETTERS_14[6]), // g
+	toSixteenSegment(LETTERS_14[7]), // h
+	toSixteenSegment(LETTERS_14[8]), // i
+	toSixteenSegment(LETTERS_14[9]), // j
+	toSixteenSegment(LETTERS_14[10]), // k
+	toSixteenSegment(LETTERS_14[11]), // l
+	toSixteenSegment(LETTERS_14[12]), // m
+	toSixteenSegment(LETTERS_14[13]), // n
+	toSixteenSegment(LETTERS_14[14]), // o
+	toSixteenSegment(LETTERS_14[15]), // p
+	toSixteenSegment(LETTERS_14[16]), // q
+	toSixteenSegment(LETTERS_14[17]), // r
+	toSixteenSegment(LETTERS_14[18]), // s
+	toSixteenSegment(LETTERS_14[19]), // t
+	toSixteenSegment(LETTERS_14[20]), // u
+	toSixteenSegment(LETTERS_14[21]), // v
+	toSixteenSegment(LETTERS_14[22]), // w
+	toSixteenSegment(LETTERS_14[23]), // x
+	toSixteenSegment(LETTERS_14[24]), // y
+	toSixteenSegment(LETTERS_14[25])  // z
+};
+
+constexpr uint16_t MINUS_16 = toSixteenSegment(MINUS_14);
+
+}
+
+constexpr SegmentType SEVEN_SEGMENT = { 7, 8, 0, SegmentEncoding::NUMBERS_7, SegmentEncoding::LETTERS_7, SegmentEncoding::MINUS_7 };
+constexpr SegmentType FOURTEEN_SEGMENT = { 14, 16, SegmentEncoding::SEGMENT_P, SegmentEncoding::NUMBERS_14, SegmentEncoding::LETTERS_14, SegmentEncoding::MINUS_14 };
+constexpr SegmentType SIXTEEN_SEGMENT = { 16, 16, -1, SegmentEncoding::NUMBERS_16, SegmentEncoding::LETTERS_16, SegmentEncoding::MINUS_16 }; // dot line is used by second half of d
+
+#endif
@@ -11,43 +11,43 @@ https://miguelpynto.github.io/ShiftDisplay/
 
 // CONSTRUCTORS ****************************************************************
 
-ShiftDisplay::ShiftDisplay(DisplayType displayType, int displaySize, DisplayDrive displayDrive) {
+ShiftDisplay::ShiftDisplay(DisplayType displayType, int displaySize, DisplayDrive displayDrive, const SegmentType &segmentType) {
 	int sectionSizes[] = {displaySize, 0}; // single section with size of display
-	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES);
+	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES, segmentType);
 }
 
-ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, DisplayDrive displayDrive) {
+ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, DisplayDrive displayDrive, const SegmentType &segmentType) {
 	int sectionSizes[] = {displaySize, 0}; // single section with size of display
-	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES);
+	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES, segmentType);
 }
 
-ShiftDisplay::ShiftDisplay(DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive) {
-	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES);
+ShiftDisplay::ShiftDisplay(DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, const SegmentType &segmentType) {
+	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES, segmentType);
 }
 
-ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive) {
-	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES);
+ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, const SegmentType &segmentType) {
+	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, displayDrive, false, DEFAULT_INDEXES, segmentType);
 }
 
 ShiftDisplay::ShiftDisplay(DisplayType displayType, int displaySize, bool swappedShiftRegisters, const int indexes[]) {
 	int sectionSizes[] = {displaySize, 0}; // single section with size of display
-	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes);
+	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes, SEVEN_SEGMENT);
 }
 
 ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, bool swappedShiftRegisters, const int indexes[]) {
 	int sectionSizes[] = {displaySize, 0}; // single section with size of display
-	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes);
+	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes, SEVEN_SEGMENT);
 }
 
 ShiftDisplay::ShiftDisplay(DisplayType displayType, const int sectionSizes[], bool swappedShiftRegisters, const int indexes[]) {
-	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes);
+	construct(DEFAULT_LATCH_PIN, DEFAULT_CLOCK_PIN, DEFAULT_DATA_PIN, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes, SEVEN_SEGMENT);
 }
 
 ShiftDisplay::ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], bool swappedShiftRegisters, const int indexes[]) {
-	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes);
+	construct(latchPin, clockPin, dataPin, displayType, sectionSizes, MULTIPLEXED_DRIVE, swappedShiftRegisters, indexes, SEVEN_SEGMENT);
 }
 
-void ShiftDisplay::construct(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, bool swappedShiftRegisters, const int indexes[]) {
+void ShiftDisplay::construct(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, bool swappedShiftRegisters, const int indexes[], const SegmentType &segmentType) {
 
 	// initialize pins
 	_latchPin = latchPin;
@@ -57,10 +57,18 @@ void ShiftDisplay::construct(int latchPin, int clockPin, int dataPin, DisplayTyp
 	pinMode(_clockPin, OUTPUT);
 	pinMode(_dataPin, OUTPUT);
 
+#ifdef SHIFTDISPLAY_TRACE
+	// initialize trace
+	_traceNext = 0;
+	_traceCount = 0;
+	_bus = 0;
+#endif
+
 	// initialize globals
 	_isCathode = displayType == COMMON_CATHODE;
-	_isMultiplexed = displayDrive == MULTIPLEXED_DRIVE;
+	_displayDrive = displayDrive;
 	_isSwapped = swappedShiftRegisters;
+	_segmentType = segmentType;
 
 	// check and initialize indexes global
 	for (int pos = 0; pos < MAX_DISPLAY_SIZE; pos++) {
@@ -87,86 +95,220 @@ void ShiftDisplay::construct(int latchPin, int clockPin, int dataPin, DisplayTyp
 		_sectionCount++;
 	}
 
+	// initialize memos
+	for (int section = 0; section < MAX_DISPLAY_SIZE; section++)
+		_memos[section].type = MEMO_NONE;
+	_memoHits = 0;
+	_memoMisses = 0;
+
+	// initialize queue
+	_queueHead = 0;
+	_queueTail = 0;
+
 	// clear cache and display
-	byte empty = _isCathode ? EMPTY : ~EMPTY;
-	memset(_cache, empty, MAX_DISPLAY_SIZE);
+	uint16_t empty = _isCathode ? EMPTY : ~EMPTY;
+	for (int i = 0; i < MAX_DISPLAY_SIZE; i++)
+		_cache[i] = empty;
+	_isFrameOutdated = true;
 	clear();
 }
 
 // PRIVATE FUNCTIONS ***********************************************************
 
+void ShiftDisplay::writeLatch(int value) {
+	digitalWrite(_latchPin, value);
+#ifdef SHIFTDISPLAY_TRACE
+	traceBus(0, value);
+#endif
+}
+
+void ShiftDisplay::writeByte(int bitOrder, byte value) {
+#if defined(SHIFTDISPLAY_TRACE) && SHIFTDISPLAY_TRACE >= SHIFTDISPLAY_TRACE_BUS
+	// same as shiftOut(), but recording every edge
+	for (int i = 0; i < 8; i++) {
+		int bit = bitRead(value, bitOrder == LSBFIRST ? i : 7 - i);
+		digitalWrite(_dataPin, bit);
+		traceBus(2, bit);
+		digitalWrite(_clockPin, HIGH);
+		traceBus(1, HIGH);
+		digitalWrite(_clockPin, LOW);
+		traceBus(1, LOW);
+	}
+#else
+	shiftOut(_dataPin, _clockPin, bitOrder, value);
+#endif
+}
+
+void ShiftDisplay::writeSegments(uint16_t code) {
+	if (_segmentType.segmentCount == 16) {
+		writeByte(LSBFIRST, lowByte(code)); // second segment shift register
+		writeByte(LSBFIRST, highByte(code)); // first segment shift register (abcdefgp)
+	} else
+		writeByte(LSBFIRST, code);
+}
+
+#ifdef SHIFTDISPLAY_TRACE
+void ShiftDisplay::traceBus(int bit, int value) {
+	if (bitRead(_bus, bit) == value && _traceCount > 0) // no change
+		return;
+	bitWrite(_bus, bit, value);
+	_trace[_traceNext].time = micros();
+	_trace[_traceNext].bus = _bus;
+	_traceNext = (_traceNext + 1) % TRACE_SIZE;
+	if (_traceCount < TRACE_SIZE)
+		_traceCount++;
+}
+#endif
+
 void ShiftDisplay::updateMultiplexedDisplay() {
+	applyQueue();
 	for (int i = 0; i < _displaySize; i++) {
-		digitalWrite(_latchPin, LOW);
+		writeLatch(LOW);
 
 		if (!_isSwapped) {
-			shiftOut(_dataPin, _clockPin, LSBFIRST, _indexes[i]); // last shift register
-			shiftOut(_dataPin, _clockPin, LSBFIRST, _cache[i]); // first shift register
+			writeByte(LSBFIRST, _indexes[i]); // last shift register
+			writeSegments(_cache[i]); // first shift register(s)
 		} else {
-			shiftOut(_dataPin, _clockPin, LSBFIRST, _cache[i]); // last shift register
-			shiftOut(_dataPin, _clockPin, LSBFIRST, _indexes[i]); // first shift register
+			writeSegments(_cache[i]); // last shift register(s)
+			writeByte(LSBFIRST, _indexes[i]); // first shift register
 		}
 
-		digitalWrite(_latchPin, HIGH);
+		writeLatch(HIGH);
 
 		delay(POV);
 	}
 }
 
 void ShiftDisplay::updateStaticDisplay() {
-	digitalWrite(_latchPin, LOW);
+	applyQueue();
+	writeLatch(LOW);
 	for (int i = _displaySize - 1; i >= 0 ; i--)
-		shiftOut(_dataPin, _clockPin, LSBFIRST, _cache[i]);
-	digitalWrite(_latchPin, HIGH);
+		writeSegments(_cache[i]);
+	writeLatch(HIGH);
+}
+
+void ShiftDisplay::updateSegmentMultiplexedDisplay() {
+	applyQueue();
+	if (_isFrameOutdated)
+		buildSegmentFrame();
+
+	for (int s = 0; s < _segmentType.segmentCount; s++) {
+		uint16_t segment = 1u << s;
+		if (!_isCathode)
+			segment = ~segment;
+
+		writeLatch(LOW);
+
+		if (!_isSwapped) {
+			writeByte(LSBFIRST, _segmentFrame[s]); // last shift register
+			writeSegments(segment); // first shift register(s)
+		} else {
+			writeSegments(segment); // last shift register(s)
+			writeByte(LSBFIRST, _segmentFrame[s]); // first shift register
+		}
+
+		writeLatch(HIGH);
+
+		delay(POV);
+	}
+}
+
+void ShiftDisplay::buildSegmentFrame() {
+	_isFrameOutdated = false; // before reading cache, so a change made meanwhile by an interrupt is built next time
+	asm volatile("" ::: "memory"); // cache must be read after
+	byte none = _isCathode ? ~EMPTY : EMPTY; // no index lit
+	for (int s = 0; s < _segmentType.segmentCount; s++) {
+		byte frame = none;
+		for (int i = 0; i < _displaySize; i++) {
+			bool lit = bitRead(_cache[i], s) == _isCathode;
+			if (lit)
+				frame = _isCathode ? frame & _indexes[i] : frame | _indexes[i];
+		}
+		_segmentFrame[s] = frame;
+	}
 }
 
 void ShiftDisplay::clearMultiplexedDisplay() {
-	digitalWrite(_latchPin, LOW);
-	shiftOut(_dataPin, _clockPin, MSBFIRST, EMPTY); // 0 at both ends of led
-	shiftOut(_dataPin, _clockPin, MSBFIRST, EMPTY);
-	digitalWrite(_latchPin, HIGH);
+	writeLatch(LOW);
+	writeByte(MSBFIRST, EMPTY); // 0 at both ends of led
+	writeSegments(EMPTY);
+	writeLatch(HIGH);
 }
 
 void ShiftDisplay::clearStaticDisplay() {
-	digitalWrite(_latchPin, LOW);
-	byte empty = _isCathode ? EMPTY : ~EMPTY;
+	writeLatch(LOW);
+	uint16_t empty = _isCathode ? EMPTY : ~EMPTY;
 	for (int i = 0; i < _displaySize; i++)
-		shiftOut(_dataPin, _clockPin, MSBFIRST, empty);
-	digitalWrite(_latchPin, HIGH);
+		writeSegments(empty);
+	writeLatch(HIGH);
+}
+
+uint16_t ShiftDisplay::widenCode(byte code) {
+	if (_segmentType.id == 14)
+		return SegmentEncoding::toFourteenSegment(code);
+	if (_segmentType.id == 16)
+		return SegmentEncoding::toSixteenSegment(SegmentEncoding::toFourteenSegment(code));
+	return code;
 }
 
-void ShiftDisplay::modifyCache(int index, byte code) {
+void ShiftDisplay::modifyCache(int index, uint16_t code) {
+	forgetMemo(index);
+	_isFrameOutdated = true;
 	_cache[index] = _isCathode ? code : ~code;
 }
 
-void ShiftDisplay::modifyCache(int beginIndex, int size, const byte codes[]) {
+void ShiftDisplay::modifyCache(int beginIndex, int size, const uint16_t codes[]) {
+	forgetMemo(beginIndex);
+	_isFrameOutdated = true;
 	for (int i = 0; i < size; i++)
 		_cache[i+beginIndex] = _isCathode ? codes[i] : ~codes[i];
 }
 
+void ShiftDisplay::modifyCache(int beginIndex, int size, const byte codes[]) {
+	uint16_t wideCodes[size];
+	for (int i = 0; i < size; i++)
+		wideCodes[i] = widenCode(codes[i]);
+	modifyCache(beginIndex, size, wideCodes);
+}
+
 void ShiftDisplay::modifyCacheDot(int index, bool dot) {
+	if (_segmentType.dotSegment == -1) // display without dots
+		return;
+	forgetMemo(index);
+	_isFrameOutdated = true;
 	bool bit = _isCathode ? dot : !dot;
-	bitWrite(_cache[index], 0, bit);
+	bitWrite(_cache[index], _segmentType.dotSegment, bit);
+}
+
+void ShiftDisplay::forgetMemo(int index) {
+	for (int section = 0; section < _sectionCount; section++) {
+		int begin = _sectionBegins[section];
+		if (index >= begin && index < begin + _sectionSizes[section]) {
+			_memos[section].type = MEMO_NONE;
+			return;
+		}
+	}
 }
 
-void ShiftDisplay::encodeCharacters(int size, const char input[], byte output[], int dotIndex = -1) {
+void ShiftDisplay::encodeCharacters(int size, const char input[], uint16_t output[], int dotIndex = -1) {
+
 	for (int i = 0; i < size; i++) {
 		char c = input[i];
 		
 		if (c >= '0' && c <= '9')
-			output[i] = NUMBERS[c - '0'];
+			output[i] = pgm_read_word(&_segmentType.numbers[c - '0']);
 		else if (c >= 'a' && c <= 'z')
-			output[i] = LETTERS[c - 'a'];
+			output[i] = pgm_read_word(&_segmentType.letters[c - 'a']);
 		else if (c >= 'A' && c <= 'Z')
-			output[i] = LETTERS[c - 'A'];
+			output[i] = pgm_read_word(&_segmentType.letters[c - 'A']);
 		else if (c == '-')
-			output[i] = MINUS;
+			output[i] = _segmentType.minus;
 		else // space or invalid
 			output[i] = EMPTY;
 	}
 	
-	if (dotIndex != -1)
-		bitWrite(output[dotIndex], 0, 1);
+	if (dotIndex != -1 && _segmentType.dotSegment != -1)
+		bitWrite(output[dotIndex], _segmentType.dotSegment, 1);
 }
 
 int ShiftDisplay::formatCharacters(int inSize, const char input[], int outSize, char output[], Alignment alignment, bool leadingZeros = false, int decimalPlaces = -1) {
@@ -245,18 +387,41 @@ int ShiftDisplay::countCharacters(double number) {
 }
 
 void ShiftDisplay::setInteger(long number, bool leadingZeros, Alignment alignment, int section) {
+
+	// skip if identical to last value set on section
+	Memo &memo = _memos[section];
+	if (memo.type == MEMO_INTEGER && memo.integer == number && memo.leadingZeros == leadingZeros && memo.alignment == alignment) {
+		_memoHits++;
+		return;
+	}
+	_memoMisses++;
+
 	int valueSize = countCharacters(number);
 	char originalCharacters[valueSize];
 	getCharacters(number, valueSize, originalCharacters);
 	int sectionSize = _sectionSizes[section];
 	char formattedCharacters[sectionSize];
 	formatCharacters(valueSize, originalCharacters, sectionSize, formattedCharacters, alignment, leadingZeros);
-	byte encodedCharacters[sectionSize];
+	uint16_t encodedCharacters[sectionSize];
 	encodeCharacters(sectionSize, formattedCharacters, encodedCharacters);
 	modifyCache(_sectionBegins[section], sectionSize, encodedCharacters);
+
+	memo.type = MEMO_INTEGER;
+	memo.integer = number;
+	memo.leadingZeros = leadingZeros;
+	memo.alignment = alignment;
 }
 
 void ShiftDisplay::setReal(double number, int decimalPlaces, bool leadingZeros, Alignment alignment, int section) {
+
+	// skip if identical to last value set on section
+	Memo &memo = _memos[section];
+	if (memo.type == MEMO_REAL && memo.real == number && memo.decimalPlaces == decimalPlaces && memo.leadingZeros == leadingZeros && memo.alignment == alignment) {
+		_memoHits++;
+		return;
+	}
+	_memoMisses++;
+
 	long value = round(number * pow(10, decimalPlaces)); // convert to integer (eg 1.236, 2 = 124)
 	int valueSize = countCharacters(number) + decimalPlaces;
 	char originalCharacters[valueSize];
@@ -264,9 +429,15 @@ void ShiftDisplay::setReal(double number, int decimalPlaces, bool leadingZeros,
 	int sectionSize = _sectionSizes[section];
 	char formattedCharacters[sectionSize];
 	int dotIndex = formatCharacters(valueSize, originalCharacters, sectionSize, formattedCharacters, alignment, leadingZeros, decimalPlaces);
-	byte encodedCharacters[sectionSize];
+	uint16_t encodedCharacters[sectionSize];
 	encodeCharacters(sectionSize, formattedCharacters, encodedCharacters, dotIndex);
 	modifyCache(_sectionBegins[section], sectionSize, encodedCharacters);
+
+	memo.type = MEMO_REAL;
+	memo.real = number;
+	memo.decimalPlaces = decimalPlaces;
+	memo.leadingZeros = leadingZeros;
+	memo.alignment = alignment;
 }
 
 void ShiftDisplay::setNumber(long number, int decimalPlaces, bool leadingZeros, Alignment alignment, int section = 0) {
@@ -284,14 +455,32 @@ void ShiftDisplay::setNumber(double number, int decimalPlaces, bool leadingZeros
 		setReal(number, decimalPlaces, leadingZeros, alignment, section);
 }
 
+void ShiftDisplay::setFormattedText(const char characters[], int section) {
+	int begin = _sectionBegins[section];
+	int sectionSize = _sectionSizes[section];
+
+	// skip if identical to last text set on section
+	Memo &memo = _memos[section];
+	if (memo.type == MEMO_TEXT && memcmp(&_memoCharacters[begin], characters, sectionSize) == 0) {
+		_memoHits++;
+		return;
+	}
+	_memoMisses++;
+
+	uint16_t encodedCharacters[sectionSize];
+	encodeCharacters(sectionSize, characters, encodedCharacters);
+	modifyCache(begin, sectionSize, encodedCharacters);
+
+	memo.type = MEMO_TEXT;
+	memcpy(&_memoCharacters[begin], characters, sectionSize);
+}
+
 void ShiftDisplay::setText(char value, Alignment alignment, int section = 0) {
 	char originalCharacters[] = {value};
 	int sectionSize = _sectionSizes[section];
 	char formattedCharacters[sectionSize];
 	formatCharacters(1, originalCharacters, sectionSize, formattedCharacters, alignment);
-	byte encodedCharacters[sectionSize];
-	encodeCharacters(sectionSize, formattedCharacters, encodedCharacters);
-	modifyCache(_sectionBegins[section], sectionSize, encodedCharacters);
+	setFormattedText(formattedCharacters, section);
 }
 
 void ShiftDisplay::setText(const char value[], Alignment alignment, int section = 0) {
@@ -299,9 +488,7 @@ void ShiftDisplay::setText(const char value[], Alignment alignment, int section
 	int sectionSize = _sectionSizes[section];
 	char formattedCharacters[sectionSize];
 	formatCharacters(valueSize, value, sectionSize, formattedCharacters, alignment);
-	byte encodedCharacters[sectionSize];
-	encodeCharacters(sectionSize, formattedCharacters, encodedCharacters);
-	modifyCache(_sectionBegins[section], sectionSize, encodedCharacters);
+	setFormattedText(formattedCharacters, section);
 }
 
 void ShiftDisplay::setText(const String &value, Alignment alignment, int section = 0) {
@@ -318,6 +505,43 @@ void ShiftDisplay::setText(const String &value, Alignment alignment, int section
 	setText(str, alignment, section); // call char array function
 }
 
+bool ShiftDisplay::enqueue(CommandType type, int section, int index, long value) {
+	byte head = _queueHead;
+	byte next = (head + 1) & (QUEUE_SIZE - 1);
+	if (next == _queueTail) // full
+		return false;
+
+	Command &command = _queue[head];
+	command.type = type;
+	command.section = section;
+	command.index = index;
+	command.value = value;
+
+	asm volatile("" ::: "memory"); // command must be written before it is published (compiler barrier only, enough for an interrupt on the same core)
+	_queueHead = next;
+	return true;
+}
+
+void ShiftDisplay::applyQueue() {
+	byte tail = _queueTail;
+	while (tail != _queueHead) {
+		asm volatile("" ::: "memory"); // command must be read after head
+		Command command = _queue[tail];
+		asm volatile("" ::: "memory"); // command must be read before its slot is released
+		tail = (tail + 1) & (QUEUE_SIZE - 1);
+		_queueTail = tail;
+
+		if (command.type == COMMAND_NUMBER)
+			setAt(command.section, command.value);
+		else if (command.type == COMMAND_DOT)
+			changeDotAt(command.section, command.index, command.value);
+		else if (command.type == COMMAND_CHARACTER)
+			changeCharacterAt(command.section, command.index, command.value);
+		else // COMMAND_WIDE_CHARACTER
+			changeWideCharacterAt(command.section, command.index, command.value);
+	}
+}
+
 bool ShiftDisplay::isValidSection(int section) {
 	return section >= 0 && section < _sectionCount;
 }
@@ -388,68 +612,80 @@ void ShiftDisplay::set(const byte customs[]) {
 	setAt(0, customs);
 }
 
+void ShiftDisplay::set(const uint16_t customs[]) {
+	setAt(0, customs);
+}
+
 void ShiftDisplay::set(const char characters[], const bool dots[]) {
 	setAt(0, characters, dots);
 }
 
+void ShiftDisplay::set(const EncodedText &text) {
+	setAt(0, text);
+}
+
+void ShiftDisplay::set(const FlashEncodedText *text) {
+	setAt(0, text);
+}
+
 void ShiftDisplay::setAt(int section, int number, int decimalPlaces, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber((long)number, decimalPlaces, leadingZeros, alignment);
+		setNumber((long)number, decimalPlaces, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, int number, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber((long)number, DEFAULT_DECIMAL_PLACES_INTEGER, leadingZeros, alignment);
+		setNumber((long)number, DEFAULT_DECIMAL_PLACES_INTEGER, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, int number, int decimalPlaces, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber((long)number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber((long)number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, int number, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber((long)number, DEFAULT_DECIMAL_PLACES_INTEGER, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber((long)number, DEFAULT_DECIMAL_PLACES_INTEGER, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, long number, int decimalPlaces, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, decimalPlaces, leadingZeros, alignment);
+		setNumber(number, decimalPlaces, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, long number, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, DEFAULT_DECIMAL_PLACES_INTEGER, leadingZeros, alignment);
+		setNumber(number, DEFAULT_DECIMAL_PLACES_INTEGER, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, long number, int decimalPlaces, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber(number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, long number, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, DEFAULT_DECIMAL_PLACES_INTEGER, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber(number, DEFAULT_DECIMAL_PLACES_INTEGER, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, double number, int decimalPlaces, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, decimalPlaces, leadingZeros, alignment);
+		setNumber(number, decimalPlaces, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, double number, bool leadingZeros, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, DEFAULT_DECIMAL_PLACES_REAL, leadingZeros, alignment);
+		setNumber(number, DEFAULT_DECIMAL_PLACES_REAL, leadingZeros, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, double number, int decimalPlaces, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber(number, decimalPlaces, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, double number, Alignment alignment) {
 	if (isValidSection(section))
-		setNumber(number, DEFAULT_DECIMAL_PLACES_REAL, DEFAULT_LEADING_ZEROS, alignment);
+		setNumber(number, DEFAULT_DECIMAL_PLACES_REAL, DEFAULT_LEADING_ZEROS, alignment, section);
 }
 
 void ShiftDisplay::setAt(int section, char value, Alignment alignment) {
@@ -474,10 +710,17 @@ void ShiftDisplay::setAt(int section, const byte customs[]) {
 	}
 }
 
+void ShiftDisplay::setAt(int section, const uint16_t customs[]) {
+	if (isValidSection(section)) {
+		int sectionSize = _sectionSizes[section];
+		modifyCache(_sectionBegins[section], sectionSize, customs);
+	}
+}
+
 void ShiftDisplay::setAt(int section, const char characters[], const bool dots[]) {
 	if (isValidSection(section)) {
 		int sectionSize = _sectionSizes[section];
-		byte encodedCharacters[sectionSize];
+		uint16_t encodedCharacters[sectionSize];
 		encodeCharacters(sectionSize, characters, encodedCharacters);
 		int begin = _sectionBegins[section];
 		modifyCache(begin, sectionSize, encodedCharacters);
@@ -486,6 +729,18 @@ void ShiftDisplay::setAt(int section, const char characters[], const bool dots[]
 	}
 }
 
+void ShiftDisplay::setAt(int section, const EncodedText &text) {
+	if (isValidSection(section))
+		if (text.size == _sectionSizes[section] && text.segmentType == _segmentType.id) // encoded for this section
+			setAt(section, text.codes);
+}
+
+void ShiftDisplay::setAt(int section, const FlashEncodedText *text) {
+	EncodedText copy;
+	memcpy_P(&copy, text, sizeof(EncodedText));
+	setAt(section, copy);
+}
+
 void ShiftDisplay::changeDot(int index, bool dot) {
 	changeDotAt(0, index, dot);
 }
@@ -494,6 +749,10 @@ void ShiftDisplay::changeCharacter(int index, byte custom) {
 	changeCharacterAt(0, index, custom);
 }
 
+void ShiftDisplay::changeWideCharacter(int index, uint16_t custom) {
+	changeWideCharacterAt(0, index, custom);
+}
+
 void ShiftDisplay::changeDotAt(int section, int relativeIndex, bool dot) {
 	if (isValidSection(section)) {
 		if (relativeIndex >= 0 && relativeIndex < _sectionSizes[section]) { // valid index in display
@@ -504,6 +763,10 @@ void ShiftDisplay::changeDotAt(int section, int relativeIndex, bool dot) {
 }
 
 void ShiftDisplay::changeCharacterAt(int section, int relativeIndex, byte custom) {
+	changeWideCharacterAt(section, relativeIndex, widenCode(custom));
+}
+
+void ShiftDisplay::changeWideCharacterAt(int section, int relativeIndex, uint16_t custom) {
 	if (isValidSection(section)) {
 		if (relativeIndex >= 0 && relativeIndex < _sectionSizes[section]) { // valid index in display
 			int index = _sectionBegins[section] + relativeIndex;
@@ -513,25 +776,76 @@ void ShiftDisplay::changeCharacterAt(int section, int relativeIndex, byte custom
 }
 
 void ShiftDisplay::update() {
-	if (_isMultiplexed)
+	if (_displayDrive == MULTIPLEXED_DRIVE)
 		updateMultiplexedDisplay();
+	else if (_displayDrive == SEGMENT_MULTIPLEXED_DRIVE)
+		updateSegmentMultiplexedDisplay();
 	else
 		updateStaticDisplay();
 }
 
 void ShiftDisplay::clear() {
-	if (_isMultiplexed)
-		clearMultiplexedDisplay();
-	else
+	if (_displayDrive == STATIC_DRIVE)
 		clearStaticDisplay();
+	else
+		clearMultiplexedDisplay(); // both multiplexed drives have the same two shift registers
+}
+
+bool ShiftDisplay::queueAt(int section, long number) {
+	return enqueue(COMMAND_NUMBER, section, 0, number);
+}
+
+bool ShiftDisplay::queueDotAt(int section, int relativeIndex, bool dot) {
+	return enqueue(COMMAND_DOT, section, relativeIndex, dot);
 }
 
+bool ShiftDisplay::queueCharacterAt(int section, int relativeIndex, byte custom) {
+	return enqueue(COMMAND_CHARACTER, section, relativeIndex, custom);
+}
+
+bool ShiftDisplay::queueWideCharacterAt(int section, int relativeIndex, uint16_t custom) {
+	return enqueue(COMMAND_WIDE_CHARACTER, section, relativeIndex, custom);
+}
+
+unsigned long ShiftDisplay::getMemoHits() {
+	return _memoHits;
+}
+
+unsigned long ShiftDisplay::getMemoMisses() {
+	return _memoMisses;
+}
+
+#ifdef SHIFTDISPLAY_TRACE
+void ShiftDisplay::dumpTrace(Print &output) {
+	int first = (_traceNext - _traceCount + TRACE_SIZE) % TRACE_SIZE;
+	for (int n = 0; n < _traceCount; n++) {
+		TraceEntry &entry = _trace[(first + n) % TRACE_SIZE];
+		output.print(entry.time);
+		output.print(' ');
+#if SHIFTDISPLAY_TRACE >= SHIFTDISPLAY_TRACE_BUS
+		output.print(bitRead(entry.bus, 0));
+		output.print(' ');
+		output.print(bitRead(entry.bus, 1));
+		output.print(' ');
+		output.println(bitRead(entry.bus, 2));
+#else
+		output.println(bitRead(entry.bus, 0));
+#endif
+	}
+}
+#endif
+
 void ShiftDisplay::show(unsigned long time) {
-	if (_isMultiplexed) {
+	if (_displayDrive == MULTIPLEXED_DRIVE) {
 		unsigned long beforeLast = millis() + time - (POV * _displaySize); // start + total - last iteration
 		while (millis() <= beforeLast) // it will not enter loop if it would overtake time
 			updateMultiplexedDisplay();
 		clearMultiplexedDisplay();
+	} else if (_displayDrive == SEGMENT_MULTIPLEXED_DRIVE) {
+		unsigned long beforeLast = millis() + time - (POV * _segmentType.segmentCount); // start + total - last iteration
+		while (millis() <= beforeLast) // it will not enter loop if it would overtake time
+			updateSegmentMultiplexedDisplay();
+		clearMultiplexedDisplay();
 	} else {
 		updateStaticDisplay();
 		delay(time);
@@ -8,6 +8,14 @@ https://miguelpynto.github.io/ShiftDisplay/
 #ifndef ShiftDisplay_h
 #define ShiftDisplay_h
 #include "Arduino.h"
+#include "SegmentEncoding.h"
+
+// uncomment to record shift register bus activity, to be dumped with dumpTrace() and converted by extras/trace2vcd.py
+// latch level only records latch changes, bus level also records every clock and data change (slower, needs a bigger trace)
+#define SHIFTDISPLAY_TRACE_LATCH 1
+#define SHIFTDISPLAY_TRACE_BUS 2
+//#define SHIFTDISPLAY_TRACE SHIFTDISPLAY_TRACE_LATCH
+#define SHIFTDISPLAY_TRACE_SIZE 128 // changes kept in trace, edit here (not in sketch) as the library is compiled apart
 
 enum DisplayType {
 	COMMON_ANODE,
@@ -15,7 +23,8 @@ enum DisplayType {
 };
 enum DisplayDrive {
 	MULTIPLEXED_DRIVE,
-	STATIC_DRIVE
+	STATIC_DRIVE,
+	SEGMENT_MULTIPLEXED_DRIVE
 };
 enum Alignment {
 	ALIGN_LEFT = 'L',
@@ -33,15 +42,88 @@ const int DEFAULT_DECIMAL_PLACES_INTEGER = 0;
 const bool DEFAULT_LEADING_ZEROS = false;
 const bool DEFAULT_CHANGE_DOT = true;
 const DisplayDrive DEFAULT_DRIVE = MULTIPLEXED_DRIVE;
+constexpr SegmentType DEFAULT_SEGMENT_TYPE = SEVEN_SEGMENT;
 const int DEFAULT_INDEXES[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
 
 const int MAX_DISPLAY_SIZE = 8;
-const int POV = 1; // milliseconds showing each character when multiplexing
+const int POV = 1; // milliseconds showing each character (or segment) when multiplexing
+const int MAX_SEGMENT_COUNT = 16; // segment lines on each display index, with two segment shift registers
+const int QUEUE_SIZE = 8; // commands waiting to be applied by update, must be a power of 2
+static_assert(QUEUE_SIZE > 0 && (QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0 && QUEUE_SIZE <= 256, "QUEUE_SIZE must be a power of 2 up to 256, queue positions wrap by mask in a byte");
+#ifdef SHIFTDISPLAY_TRACE
+const int TRACE_SIZE = SHIFTDISPLAY_TRACE_SIZE; // changes kept in trace, oldest are overwritten
+#endif
+
+// constant text encoded at compile time, declared by ENCODED_TEXT() or FLASH_ENCODED_TEXT()
+struct EncodedText {
+	uint16_t codes[MAX_DISPLAY_SIZE];
+	int size; // section size the text was arranged for
+	byte segmentType; // id of the segment type the text was encoded for
+};
+
+// constant text in program memory, only reachable by pointer (like __FlashStringHelper) so it cannot be created elsewhere
+class FlashEncodedText;
+
+namespace SegmentEncoding {
+
+// a character in the segment type format
+// encoding functions read fonts as plain data, so they are only used through the macros below, which evaluate them at compile time
+constexpr uint16_t encodeCharacter(char c, const SegmentType &type) {
+	return c >= '0' && c <= '9' ? type.numbers[c - '0']
+		: c >= 'a' && c <= 'z' ? type.letters[c - 'a']
+		: c >= 'A' && c <= 'Z' ? type.letters[c - 'A']
+		: c == '-' ? type.minus
+		: 0; // space or invalid
+}
+
+// index of first text character on section, same as formatCharacters()
+constexpr int textLeft(int length, int size, Alignment alignment) {
+	return alignment == ALIGN_LEFT ? 0 : alignment == ALIGN_RIGHT ? size - length : (size - length) / 2;
+}
+
+// character at a section index, space if outside of text
+constexpr char textCharacterAt(const char text[], int length, int left, int index) {
+	return index - left >= 0 && index - left < length ? text[index - left] : ' ';
+}
+
+// sequence of indexes 0 to N-1, to expand each cache position
+template <int... Indexes>
+struct TextIndexes {};
+template <int N, int... Indexes>
+struct MakeTextIndexes : MakeTextIndexes<N - 1, N - 1, Indexes...> {};
+template <int... Indexes>
+struct MakeTextIndexes<0, Indexes...> {
+	typedef TextIndexes<Indexes...> type;
+};
+
+template <int... Indexes>
+constexpr EncodedText encodeText(const char text[], int length, int size, Alignment alignment, const SegmentType &type, TextIndexes<Indexes...>) {
+	return EncodedText{{ (Indexes < size ? encodeCharacter(textCharacterAt(text, length, textLeft(length, size, alignment), Indexes), type) : (uint16_t) 0)... }, size, type.id};
+}
+
+// arrange and encode a string literal for a section of given size
+template <int N>
+constexpr EncodedText encodeText(const char (&text)[N], int size, Alignment alignment = DEFAULT_ALIGN_TEXT, const SegmentType &segmentType = DEFAULT_SEGMENT_TYPE) {
+	return encodeText(text, N - 1, size, alignment, segmentType, MakeTextIndexes<MAX_DISPLAY_SIZE>::type());
+}
+
+}
+
+// declare constant text arranged and encoded at compile time, arguments after name: text, size[, alignment[, segmentType]], eg:
+// ENCODED_TEXT(END, "End", 3); // in RAM, as a const EncodedText
+// FLASH_ENCODED_TEXT(END, "End", 3); // in program memory, as a const FlashEncodedText *
+// display.set(END);
+#define ENCODED_TEXT(name, ...) \
+	constexpr EncodedText name = SegmentEncoding::encodeText(__VA_ARGS__)
+#define FLASH_ENCODED_TEXT(name, ...) \
+	static constexpr EncodedText name##_ENCODED_TEXT PROGMEM = SegmentEncoding::encodeText(__VA_ARGS__); \
+	static const FlashEncodedText * const name = reinterpret_cast<const FlashEncodedText *>(&name##_ENCODED_TEXT)
 
 class ShiftDisplay {
 
 	// MD: for multiplexed drive displays
 	// SD: for static drive displays
+	// SMD: for segment multiplexed drive displays
 
 	private:
 
@@ -49,27 +131,90 @@ class ShiftDisplay {
 		int _clockPin;
 		int _dataPin;
 		bool _isCathode;
-		bool _isMultiplexed;
+		DisplayDrive _displayDrive;
 		bool _isSwapped; // shift registers are swapped (first indexes then segments)
+		SegmentType _segmentType; // encoding and font of display characters
 		int _displaySize; // length of whole display
 		int _sectionCount; // quantity of display sections
 		int _sectionSizes[MAX_DISPLAY_SIZE]; // length of each section
 		int _sectionBegins[MAX_DISPLAY_SIZE]; // index where each section begins on whole display
 		byte _indexes[MAX_DISPLAY_SIZE]; // each display index in order (encoded)
-		byte _cache[MAX_DISPLAY_SIZE]; // value to show on display (encoded in abcdefgp format)
+		uint16_t _cache[MAX_DISPLAY_SIZE]; // value to show on display (encoded in abcdefgp format, or 14/16 segment format)
+		byte _segmentFrame[MAX_SEGMENT_COUNT]; // SMD: cache transposed, each segment line with the indexes it lights (encoded)
+		volatile bool _isFrameOutdated; // SMD: cache changed since segment frame was built, may be set by an interrupt
+
+		enum CommandType {
+			COMMAND_NUMBER,
+			COMMAND_DOT,
+			COMMAND_CHARACTER,
+			COMMAND_WIDE_CHARACTER
+		};
+		struct Command {
+			CommandType type;
+			int section;
+			int index; // relative to section
+			long value; // number, dot or custom character
+		};
+		Command _queue[QUEUE_SIZE]; // single producer single consumer ring buffer, producer may be an interrupt on the same core
+		volatile byte _queueHead; // position to write next command, only modified by producer
+		volatile byte _queueTail; // position to read next command, only modified by consumer
+		bool enqueue(CommandType type, int section, int index, long value); // add command to queue, returns false if full
+		void applyQueue(); // execute and remove every queued command
+
+#ifdef SHIFTDISPLAY_TRACE
+		struct TraceEntry {
+			unsigned long time; // microseconds
+			byte bus; // pin levels: bit 0 latch, bit 1 clock, bit 2 data
+		};
+		TraceEntry _trace[TRACE_SIZE]; // ring buffer of bus changes
+		int _traceNext; // position in trace to record next change
+		int _traceCount; // quantity of valid entries in trace
+		byte _bus; // current pin levels, same format as trace entries
+		void traceBus(int bit, int value); // record a pin level change in trace
+#endif
 
-		void construct(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, bool swappedShiftRegisters, const int indexes[]); // common instructions to be called by constructors
+		enum MemoType {
+			MEMO_NONE, // cache was modified by other means, memo is not valid
+			MEMO_INTEGER,
+			MEMO_REAL,
+			MEMO_TEXT
+		};
+		struct Memo {
+			MemoType type;
+			union { // only the one of type is valid
+				long integer;
+				double real;
+			};
+			int decimalPlaces;
+			bool leadingZeros;
+			Alignment alignment;
+		};
+		Memo _memos[MAX_DISPLAY_SIZE]; // last value set on each section, to skip redoing an identical one
+		char _memoCharacters[MAX_DISPLAY_SIZE]; // last formatted text on each display index
+		unsigned long _memoHits; // quantity of set calls skipped for being identical to last
+		unsigned long _memoMisses; // quantity of set calls formatted and encoded
+
+		void construct(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive, bool swappedShiftRegisters, const int indexes[], const SegmentType &segmentType); // common instructions to be called by constructors
+
+		void writeLatch(int value); // set latch pin level
+		void writeByte(int bitOrder, byte value); // shift a byte out to the shift registers
+		void writeSegments(uint16_t code); // shift a character out to the segment shift registers (one or two)
 
 		void updateMultiplexedDisplay(); // MD: iterate stored value on each display index, achieving persistence of vision
 		void updateStaticDisplay(); // SD: send stored value to whole display
+		void updateSegmentMultiplexedDisplay(); // SMD: iterate each segment line on all display indexes at once, achieving persistence of vision
+		void buildSegmentFrame(); // SMD: transpose cache into segment frame
 		void clearMultiplexedDisplay(); // MD: clear both shift registers
 		void clearStaticDisplay(); // SD: clear all shift registers
 
-		void modifyCache(int index, byte code); // replace a position in cache
-		void modifyCache(int beginIndex, int size, const byte codes[]); // replace a interval in cache
+		uint16_t widenCode(byte code); // convert a character in abcdefgp format to the display segment type
+		void modifyCache(int index, uint16_t code); // replace a position in cache
+		void modifyCache(int beginIndex, int size, const uint16_t codes[]); // replace a interval in cache
+		void modifyCache(int beginIndex, int size, const byte codes[]); // replace a interval in cache, with characters in abcdefgp format
 		void modifyCacheDot(int index, bool dot); // change dot in a cache position
+		void forgetMemo(int index); // invalidate memo of the section containing a display index
 
-		void encodeCharacters(int size, const char input[], byte output[], int dotIndex); // encode array of chars to array of bytes in abcdefgp format
+		void encodeCharacters(int size, const char input[], uint16_t output[], int dotIndex); // encode array of chars to array of codes in display segment type format
 		int formatCharacters(int inSize, const char input[], int outSize, char output[], Alignment alignment, bool leadingZeros, int decimalPlaces); // arrange array of chars for displaying in specified alignment, returns dot index on display or -1 if none
 		void getCharacters(long input, int size, char output[]); // convert an integer number to an array of chars
 		int countCharacters(long number); // calculate the length of an array of chars for an integer number
@@ -79,6 +224,7 @@ class ShiftDisplay {
 		void setReal(double value, int decimalPlaces, bool leadingZeros, Alignment alignment, int section);
 		void setNumber(long number, int decimalPlaces, bool leadingZeros, Alignment alignment, int section);
 		void setNumber(double number, int decimalPlaces, bool leadingZeros, Alignment alignment, int section);
+		void setFormattedText(const char characters[], int section); // encode and cache text already arranged for section, unless identical to last
 		void setText(char value, Alignment alignment, int section);
 		void setText(const char value[], Alignment alignment, int section);
 		void setText(const String &value, Alignment alignment, int section);
@@ -88,10 +234,10 @@ class ShiftDisplay {
 	public:
 
 		// constructors
-		ShiftDisplay(DisplayType displayType, int displaySize, DisplayDrive displayDrive = DEFAULT_DRIVE); // default connections, whole display, default pins
-		ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, DisplayDrive displayDrive = DEFAULT_DRIVE); // default connections, whole display, custom pins
-		ShiftDisplay(DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive = DEFAULT_DRIVE); // default connections, sectioned display, default pins
-		ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive = DEFAULT_DRIVE); // default connections, sectioned display, custom pins
+		ShiftDisplay(DisplayType displayType, int displaySize, DisplayDrive displayDrive = DEFAULT_DRIVE, const SegmentType &segmentType = DEFAULT_SEGMENT_TYPE); // default connections, whole display, default pins
+		ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, DisplayDrive displayDrive = DEFAULT_DRIVE, const SegmentType &segmentType = DEFAULT_SEGMENT_TYPE); // default connections, whole display, custom pins
+		ShiftDisplay(DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive = DEFAULT_DRIVE, const SegmentType &segmentType = DEFAULT_SEGMENT_TYPE); // default connections, sectioned display, default pins
+		ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, const int sectionSizes[], DisplayDrive displayDrive = DEFAULT_DRIVE, const SegmentType &segmentType = DEFAULT_SEGMENT_TYPE); // default connections, sectioned display, custom pins
 		ShiftDisplay(DisplayType displayType, int displaySize, bool swappedShiftRegisters, const int indexes[] = DEFAULT_INDEXES); // custom connections, whole display, default pins
 		ShiftDisplay(int latchPin, int clockPin, int dataPin, DisplayType displayType, int displaySize, bool swappedShiftRegisters, const int indexes[] = DEFAULT_INDEXES); // custom connections, whole display, custom pins
 		ShiftDisplay(DisplayType displayType, const int sectionSizes[], bool swappedShiftRegisters, const int indexes[] = DEFAULT_INDEXES); // custom connections, sectioned display, default pins
@@ -114,7 +260,10 @@ class ShiftDisplay {
 		void set(const char value[], Alignment alignment = DEFAULT_ALIGN_TEXT); // c string
 		void set(const String &value, Alignment alignment = DEFAULT_ALIGN_TEXT); // Arduino string object
 		void set(const byte customs[]); // custom characters (encoded in abcdefgp format), array length must match display size
+		void set(const uint16_t customs[]); // custom characters (encoded in 14/16 segment format), array length must match display size
 		void set(const char characters[], const bool dots[]); // arrays length must match display size
+		void set(const EncodedText &text); // constant text, encoded for display size
+		void set(const FlashEncodedText *text); // constant text in program memory, encoded for display size
 		void setAt(int section, int number, int decimalPlaces = DEFAULT_DECIMAL_PLACES_INTEGER, bool leadingZeros = DEFAULT_LEADING_ZEROS, Alignment alignment = DEFAULT_ALIGN_NUMBER);
 		void setAt(int section, int number, bool leadingZeros, Alignment alignment = DEFAULT_ALIGN_NUMBER); // override decimalPlaces obligation
 		void setAt(int section, int number, int decimalPlaces, Alignment alignment); // override leadingZeros obligation
@@ -131,13 +280,24 @@ class ShiftDisplay {
 		void setAt(int section, const char value[], Alignment alignment = DEFAULT_ALIGN_TEXT); // c string
 		void setAt(int section, const String &value, Alignment alignment = DEFAULT_ALIGN_TEXT); // Arduino string object
 		void setAt(int section, const byte customs[]); // custom characters (encoded in abcdefgp format), array length must match defined section size
+		void setAt(int section, const uint16_t customs[]); // custom characters (encoded in 14/16 segment format), array length must match defined section size
 		void setAt(int section, const char characters[], const bool dots[]); // arrays length must match defined section size
+		void setAt(int section, const EncodedText &text); // constant text, encoded for defined section size and segment type
+		void setAt(int section, const FlashEncodedText *text); // constant text in program memory, encoded for defined section size and segment type
 
 		// modify cached value at index
 		void changeDot(int index, bool dot = DEFAULT_CHANGE_DOT); // show or hide a dot on character
 		void changeCharacter(int index, byte custom); // replace with a custom character (encoded in abcdefgp format)
+		void changeWideCharacter(int index, uint16_t custom); // replace with a custom character (encoded in 14/16 segment format)
 		void changeDotAt(int section, int relativeIndex, bool dot = DEFAULT_CHANGE_DOT); // show or hide a dot on character
 		void changeCharacterAt(int section, int relativeIndex, byte custom); // replace with a custom character (encoded in abcdefgp format)
+		void changeWideCharacterAt(int section, int relativeIndex, uint16_t custom); // replace with a custom character (encoded in 14/16 segment format)
+
+		// queue a modification to be cached by next update/show, safe to call from an interrupt on the same core as update (not from another core or task); returns false if queue is full
+		bool queueAt(int section, long number); // integer with default formatting
+		bool queueDotAt(int section, int relativeIndex, bool dot = DEFAULT_CHANGE_DOT); // show or hide a dot on character
+		bool queueCharacterAt(int section, int relativeIndex, byte custom); // replace with a custom character (encoded in abcdefgp format)
+		bool queueWideCharacterAt(int section, int relativeIndex, uint16_t custom); // replace with a custom character (encoded in 14/16 segment format)
 
 		// show cached value on display
 		void update(); // MD: for a single iteration; SD: while not update/clear/show called
@@ -145,6 +305,15 @@ class ShiftDisplay {
 		// clear display content
 		void clear();
 
+		// memo statistics, for checking how many set calls were skipped for being identical to last
+		unsigned long getMemoHits();
+		unsigned long getMemoMisses();
+
+#ifdef SHIFTDISPLAY_TRACE
+		// print recorded changes, oldest first, one per line as: microseconds latch [clock data]
+		void dumpTrace(Print &output);
+#endif
+
 		// show cached value on display for the specified time (or less if would exceed it)
 		void show(unsigned long time);
 
@@ -0,0 +1,108 @@
+/*
+ShiftDisplay
+by MiguelPynto
+Arduino library for driving 7-segment displays using shift registers
+https://miguelpynto.github.io/ShiftDisplay/
+*/
+
+#include "Arduino.h"
+#include "ShiftDisplayDecoder.h"
+
+// CONSTRUCTORS ****************************************************************
+
+ShiftDisplayDecoder::ShiftDisplayDecoder(ShiftDisplay &display) : _display(display) {
+	_state = WAIT_SYNC;
+}
+
+// PRIVATE FUNCTIONS ***********************************************************
+
+bool ShiftDisplayDecoder::apply() {
+	if (_command == FRAME_CHARACTERS && _length <= MAX_DISPLAY_SIZE) {
+		char characters[MAX_DISPLAY_SIZE];
+		bool dots[MAX_DISPLAY_SIZE];
+		for (int i = 0; i < MAX_DISPLAY_SIZE; i++) {
+			characters[i] = i < _length ? _payload[i] : ' ';
+			dots[i] = false;
+		}
+		_display.setAt(_section, characters, dots);
+		return true;
+	} else if (_command == FRAME_CUSTOMS && _length <= MAX_DISPLAY_SIZE) {
+		for (int i = _length; i < MAX_DISPLAY_SIZE; i++)
+			_payload[i] = 0; // empty character
+		_display.setAt(_section, _payload);
+		return true;
+	} else if (_command == FRAME_WIDE_CUSTOMS && _length % 2 == 0) {
+		uint16_t customs[MAX_DISPLAY_SIZE];
+		for (int i = 0; i < MAX_DISPLAY_SIZE; i++)
+			customs[i] = 2 * i < _length ? word(_payload[2 * i], _payload[2 * i + 1]) : 0; // missing is empty character
+		_display.setAt(_section, customs);
+		return true;
+	} else if (_command == FRAME_DOTS && _length == 1) {
+		for (int i = 0; i < MAX_DISPLAY_SIZE; i++)
+			_display.changeDotAt(_section, i, bitRead(_payload[0], i)); // out of section indexes have no effect
+		return true;
+	}
+	return false;
+}
+
+// PUBLIC FUNCTIONS ************************************************************
+
+bool ShiftDisplayDecoder::decode(byte data) {
+	switch (_state) {
+
+		case WAIT_SYNC:
+			if (data == FRAME_SYNC)
+				_state = WAIT_COMMAND;
+			return false;
+
+		case WAIT_COMMAND:
+			if (data == FRAME_SYNC) // never a command, idle or frame cut short after its sync
+				return false;
+			_command = data;
+			_checksum = data;
+			_state = WAIT_SECTION;
+			return false;
+
+		case WAIT_SECTION:
+			_section = data;
+			_checksum ^= data;
+			_state = WAIT_LENGTH;
+			return false;
+
+		case WAIT_LENGTH:
+			if (data > MAX_FRAME_PAYLOAD) { // malformed, look for next frame
+				_state = data == FRAME_SYNC ? WAIT_COMMAND : WAIT_SYNC; // frame was cut short, this may begin the next one
+				return false;
+			}
+			_length = data;
+			_received = 0;
+			_checksum ^= data;
+			_state = data > 0 ? WAIT_PAYLOAD : WAIT_CHECKSUM;
+			return false;
+
+		case WAIT_PAYLOAD:
+			_payload[_received++] = data;
+			_checksum ^= data;
+			if (_received == _length)
+				_state = WAIT_CHECKSUM;
+			return false;
+
+		case WAIT_CHECKSUM:
+			_state = WAIT_SYNC;
+			if (data != _checksum) { // corrupted, discard
+				if (data == FRAME_SYNC) // frame was cut short, this may begin the next one
+					_state = WAIT_COMMAND;
+				return false;
+			}
+			return apply();
+	}
+	return false;
+}
+
+int ShiftDisplayDecoder::decode(Stream &input) {
+	int frames = 0;
+	while (input.available() > 0)
+		if (decode((byte) input.read()))
+			frames++;
+	return frames;
+}
@@ -0,0 +1,57 @@
+/*
+ShiftDisplay
+by MiguelPynto
+Arduino library for driving 7-segment displays using shift registers
+https://miguelpynto.github.io/ShiftDisplay/
+*/
+
+#ifndef ShiftDisplayDecoder_h
+#define ShiftDisplayDecoder_h
+#include "Arduino.h"
+#include "ShiftDisplay.h"
+
+// frame: SYNC, command, section, length, payload (length bytes), checksum (xor of command to last payload byte)
+
+const byte FRAME_SYNC = 0x7E;
+const int MAX_FRAME_PAYLOAD = 2 * MAX_DISPLAY_SIZE; // bytes, for wide customs
+
+enum FrameCommand {
+	FRAME_CHARACTERS = 'C', // payload: characters for the section, from left to right, missing ones are spaces; dots are hidden
+	FRAME_CUSTOMS = 'S', // payload: custom characters (encoded in abcdefgp format) for the section, missing ones are empty
+	FRAME_WIDE_CUSTOMS = 'W', // payload: custom characters (encoded in 14/16 segment format, high byte first) for the section, missing ones are empty
+	FRAME_DOTS = 'D' // payload: one byte, bit n shows or hides dot at section index n
+};
+
+class ShiftDisplayDecoder {
+
+	private:
+
+		enum State {
+			WAIT_SYNC,
+			WAIT_COMMAND,
+			WAIT_SECTION,
+			WAIT_LENGTH,
+			WAIT_PAYLOAD,
+			WAIT_CHECKSUM
+		};
+
+		ShiftDisplay &_display;
+		State _state;
+		byte _command;
+		byte _section;
+		byte _length; // payload length declared in frame
+		byte _received; // payload bytes received so far
+		byte _checksum; // running xor of frame bytes
+		byte _payload[MAX_FRAME_PAYLOAD];
+
+		bool apply(); // execute a complete and valid frame on display, returns false if command is unknown or malformed
+
+	public:
+
+		ShiftDisplayDecoder(ShiftDisplay &display);
+
+		bool decode(byte data); // consume one byte, returns true if it completed a frame that was applied
+		int decode(Stream &input); // consume all available bytes, returns quantity of frames applied
+};
+
+#endif